@@ -207,6 +207,13 @@ body {
 .phase-question { background: #E3F2FD; color: #1976D2; }
 .phase-reveal { background: #F3E5F5; color: #7B1FA2; }
 .phase-leaderboard { background: #FCE4EC; color: #C2185B; }
+.q-media {
+  display: block;
+  max-width: 100%;
+  max-height: 260px;
+  margin: 0 auto 16px;
+  border-radius: 12px;
+}
 </style></head><body>
 <div class="card">
   <div class="header">
@@ -235,6 +242,8 @@ body {
 
   <div class="question-area">
     <h2>Pregunta <span id="q-num">1</span> de <span id="q-total">15</span></h2>
+    <img class="q-media" id="q-img" alt="" style="display:none">
+    <audio class="q-media" id="q-aud" controls style="display:none"></audio>
     <div class="question-text" id="q-text">Presiona "Siguiente Pregunta" para comenzar</div>
     <div class="options" id="opts"></div>
     <div class="progress-bar">
@@ -247,6 +256,7 @@ body {
     <button class="btn btn-secondary" onclick="host('start')">▶️ Iniciar Ronda</button>
     <button class="btn btn-accent" onclick="host('reveal')">👁️ Revelar Respuestas</button>
     <button class="btn btn-purple" onclick="host('reset')">🔄 Resetear Todo</button>
+    <button class="btn btn-secondary" id="ap-btn" onclick="host('autopilot?on=' + (apOn ? 0 : 1))">🤖 Piloto automático: OFF</button>
   </div>
 
   <div class="leaderboard">
@@ -257,12 +267,16 @@ body {
   </div>
 </div>
 
+<script src="/media.js"></script>
 <script>
 const pinEl=document.getElementById('pin'), pcEl=document.getElementById('pc');
 const phEl=document.getElementById('ph'), tlEl=document.getElementById('tl');
 const qNumEl=document.getElementById('q-num'), qTotalEl=document.getElementById('q-total');
 const qTextEl=document.getElementById('q-text'), optsEl=document.getElementById('opts');
 const lbEl=document.getElementById('lb'), progressEl=document.getElementById('progress');
+const qImgEl=document.getElementById('q-img'), qAudEl=document.getElementById('q-aud');
+const apBtn=document.getElementById('ap-btn');
+let apOn = false;
 
 async function host(cmd){
   await fetch('/api/host/'+cmd, {cache:'no-store'});
@@ -279,20 +293,46 @@ function phaseClass(p){
   return classes[p] || '';
 }
 
+let pollTimer = null;
+
+// Cuenta atrás local entre sondeos; cada /api/state la vuelve a sincronizar.
+// El tiempo de la pregunta no corre hasta startAt (cuenta previa)
+let deadline = 0, startAt = 0;
+function showTimeLeft(){
+  tlEl.textContent = Math.max(0, Math.ceil((deadline - Math.max(Date.now(), startAt)) / 1000)) + 's';
+}
+setInterval(showTimeLeft, 250);
+
 async function tick(){
-  const r=await fetch('/api/state', {cache:'no-store'});
-  const s=await r.json();
+  clearTimeout(pollTimer);
+  let wait = 1000;
+  try {
+    const r=await fetch('/api/state', {cache:'no-store'});
+    const s=await r.json();
+    wait = s.next_poll_ms || 500;
+    render(s);
+  } catch (e) {}
+  clearTimeout(pollTimer);
+  pollTimer = setTimeout(tick, wait);
+}
 
+function render(s){
   pinEl.textContent = s.pin;
   pcEl.textContent = s.players + (s.players_answered ? ` (${s.players_answered} respondieron)` : '');
-  phEl.textContent = phaseName(s.phase);
+  phEl.textContent = s.starts_in_ms > 0 ? '¡PREPARADOS!' : phaseName(s.phase);
   phEl.className = 'phase-indicator ' + phaseClass(s.phase);
-  tlEl.textContent = Math.ceil(s.time_left_ms/1000) + 's';
+  startAt = Date.now() + s.starts_in_ms;
+  deadline = startAt + s.time_left_ms;
+  showTimeLeft();
+  apOn = !!s.autopilot;
+  apBtn.textContent = '🤖 Piloto automático: ' + (apOn ? 'ON' : 'OFF');
 
   if (s.phase === 4) {
-    qNumEl.textContent = s.q_total;
+    qNumEl.textContent = s.final ? s.q_total : s.q_index + 1;
     qTotalEl.textContent = s.q_total;
-    qTextEl.textContent = '🏁 Fin de la partida — revisa los ganadores abajo';
+    qTextEl.textContent = s.final
+      ? '🏁 Fin de la partida — revisa los ganadores abajo'
+      : '📊 Clasificación parcial — la siguiente pregunta empieza enseguida';
     optsEl.innerHTML = '';
     progressEl.style.width = '100%';
   } else {
@@ -313,6 +353,8 @@ async function tick(){
     }
   }
 
+  updateMedia(s, qImgEl, qAudEl);
+
   const answered = s.players_answered || 0;
   const total = s.players || 1;
   const progress = (answered / total) * 100;
@@ -337,7 +379,6 @@ async function tick(){
   }
 }
 
-setInterval(tick, 500);
 tick();
 </script>
 </body></html>
@@ -552,6 +593,13 @@ input:focus {
 .final-score {
   color: var(--primary);
 }
+.q-media {
+  display: block;
+  max-width: 100%;
+  max-height: 260px;
+  margin: 0 auto 16px;
+  border-radius: 12px;
+}
 </style></head><body>
 <div class="card">
   <div id="joinScreen">
@@ -564,6 +612,9 @@ input:focus {
     <div class="input-group">
       <input id="name" placeholder="Tu nombre" maxlength="16">
     </div>
+    <div class="input-group">
+      <input id="token" placeholder="Código de alumno (opcional)" maxlength="16">
+    </div>
     <button class="btn" onclick="join()">🚀 Unirse al Juego</button>
     <div id="joinMessage"></div>
   </div>
@@ -586,6 +637,8 @@ input:focus {
 
     <div class="question-area">
       <div class="question-number" id="questionNum">Pregunta 1 de 15</div>
+      <img class="q-media" id="questionImg" alt="" style="display:none">
+      <audio class="q-media" id="questionAudio" controls style="display:none"></audio>
       <div class="question-text" id="questionText">Esperando a que inicie el juego...</div>
 
       <div id="timerContainer" style="display:none;">
@@ -601,6 +654,7 @@ input:focus {
   </div>
 </div>
 
+<script src="/media.js"></script>
 <script>
 let playerId = 0;
 let selectedAnswer = -1;
@@ -620,6 +674,8 @@ const statusArea = document.getElementById('statusArea');
 const timerContainer = document.getElementById('timerContainer');
 const timerText = document.getElementById('timerText');
 const timerCircle = document.getElementById('timerCircle');
+const questionImg = document.getElementById('questionImg');
+const questionAudio = document.getElementById('questionAudio');
 
 function showMessage(text, type = 'info') {
   joinMessage.innerHTML = `<div class="message ${type}">${text}</div>`;
@@ -628,15 +684,20 @@ function showMessage(text, type = 'info') {
 async function join() {
   const pin = document.getElementById('pin').value.trim();
   const name = document.getElementById('name').value.trim();
+  const token = document.getElementById('token').value.trim();
   if (!pin || !name) { showMessage('Por favor ingresa el PIN y tu nombre', 'error'); return; }
 
   try {
-    const r = await fetch(`/api/join?pin=${encodeURIComponent(pin)}&name=${encodeURIComponent(name)}`);
+    const r = await fetch(`/api/join?pin=${encodeURIComponent(pin)}&name=${encodeURIComponent(name)}&token=${encodeURIComponent(token)}`);
     const data = await r.json();
     if (data.ok) {
       playerId = data.pid;
       playerIcon.textContent = data.icon;
       playerName.textContent = data.name;
+      if (data.profile) {
+        playerName.title = `${data.profile.games} partidas · ${data.profile.score} pts · ${data.profile.accuracy}% aciertos · racha ${data.profile.best_streak}`;
+        playerName.textContent = `${data.name} (${data.profile.games} partidas)`;
+      }
       joinScreen.style.display = 'none';
       gameScreen.style.display = 'block';
       startGameLoop();
@@ -648,6 +709,17 @@ async function join() {
   }
 }
 
+// Cuenta atrás local entre sondeos; cada /api/state la vuelve a sincronizar.
+// El tiempo de la pregunta no corre hasta startAt (cuenta previa)
+let deadline = 0, startAt = 0;
+setInterval(() => {
+  if (timerContainer.style.display !== 'none') {
+    updateTimer(Math.max(0, Math.ceil((deadline - Math.max(Date.now(), startAt)) / 1000)));
+  }
+  const leadIn = document.getElementById('leadIn');
+  if (leadIn) leadIn.textContent = Math.max(1, Math.ceil((startAt - Date.now()) / 1000));
+}, 250);
+
 function updateTimer(seconds) {
   const total = 20;
   const progress = ((total - seconds) / total) * 360;
@@ -655,7 +727,7 @@ function updateTimer(seconds) {
   timerText.textContent = seconds;
 }
 
-function createAnswerButtons(options, phase, answered, correct) {
+function createAnswerButtons(options, phase, answered, correct, locked) {
   answerGrid.innerHTML = '';
   options.forEach((opt, i) => {
     const btn = document.createElement('button');
@@ -666,7 +738,7 @@ function createAnswerButtons(options, phase, answered, correct) {
       if (i === correct) btn.classList.add('correct');
       if (answered && i === selectedAnswer && i !== correct) btn.classList.add('incorrect');
       btn.disabled = true;
-    } else if (phase === 2 && !answered) {
+    } else if (phase === 2 && !answered && !locked) {
       btn.onclick = () => selectAnswer(i);
     } else if (answered && i === selectedAnswer) {
       btn.classList.add('selected');
@@ -711,12 +783,14 @@ function selectAnswer(option) {
   statusArea.innerHTML = '<div class="status answered">✅ Respuesta enviada</div>';
 }
 
-function updateStatus(phase, answered, correct, timeLeft) {
+function updateStatus(phase, answered, correct, timeLeft, final, startsIn) {
   if (phase === 0) {
     statusArea.innerHTML = '<div class="status waiting">⏳ Esperando a que el host inicie el juego...</div>';
     timerContainer.style.display = 'none';
   } else if (phase === 2) {
-    statusArea.innerHTML = answered
+    statusArea.innerHTML = startsIn > 0
+      ? `<div class="status waiting">🚦 ¡Prepárate! Empieza en <span id="leadIn">${Math.ceil(startsIn / 1000)}</span>s</div>`
+      : answered
       ? '<div class="status answered">✅ Respuesta enviada, esperando a los demás...</div>'
       : '<div class="status waiting">🤔 Selecciona tu respuesta antes de que se acabe el tiempo</div>';
     timerContainer.style.display = 'block';
@@ -731,7 +805,9 @@ function updateStatus(phase, answered, correct, timeLeft) {
     }
     timerContainer.style.display = 'none';
   } else if (phase === 4) {
-    statusArea.innerHTML = '<div class="status correct">🏁 Partida finalizada. ¡Mira la clasificación!</div>';
+    statusArea.innerHTML = final
+      ? '<div class="status correct">🏁 Partida finalizada. ¡Mira la clasificación!</div>'
+      : '<div class="status waiting">⏳ La siguiente pregunta empieza enseguida...</div>';
     timerContainer.style.display = 'none';
   } else {
     statusArea.innerHTML = '<div class="status waiting">🎯 Preparando...</div>';
@@ -741,27 +817,32 @@ function updateStatus(phase, answered, correct, timeLeft) {
 
 async function startGameLoop() {
   while (true) {
+    let wait = 1000;
     try {
       const r = await fetch(`/api/state?pid=${playerId}`);
       const s = await r.json();
+      wait = s.next_poll_ms || 500;
+      startAt = Date.now() + s.starts_in_ms;
+      deadline = startAt + s.time_left_ms;
 
       scoreEl.textContent = s.me_score || 0;
       streakEl.textContent = s.me_streak || 0;
 
       if (s.phase === 4) {
-        questionNum.textContent = '🏁 Final';
-        questionText.textContent = '🏆 Clasificación final';
+        questionNum.textContent = s.final ? '🏁 Final' : '📊 Clasificación';
+        questionText.textContent = s.final ? '🏆 Clasificación final' : `🏆 Tras la pregunta ${s.q_index + 1}`;
         renderFinalLeaderboard(s.leaderboard);
       } else {
         questionNum.textContent = `Pregunta ${s.q_index + 1} de ${s.q_total}`;
         questionText.textContent = s.q_visible ? s.q_text : '⏳ Esperando la siguiente pregunta...';
-        if (s.q_visible) createAnswerButtons(s.q_opts, s.phase, s.me_answered, s.correct);
+        if (s.q_visible) createAnswerButtons(s.q_opts, s.phase, s.me_answered, s.correct, s.starts_in_ms > 0);
         else answerGrid.innerHTML = '';
       }
 
-      updateStatus(s.phase, s.me_answered, s.me_correct, s.time_left_ms);
+      updateMedia(s, questionImg, questionAudio);
+      updateStatus(s.phase, s.me_answered, s.me_correct, s.time_left_ms, s.final, s.starts_in_ms);
     } catch (e) {}
-    await new Promise(resolve => setTimeout(resolve, 500));
+    await new Promise(resolve => setTimeout(resolve, wait));
   }
 }
 </script>
@@ -0,0 +1,21 @@
+// Recorre la sesión con un sketch anterior a la biblioteca (SKETCH, ver
+// `make reference`) e imprime su transcripción para compararla con expected/.
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WebServer.h>
+#include <LittleFS.h>
+#include "session.h"
+
+#include SKETCH
+
+int main(int argc, char** argv) {
+  fakeMillis = 1000;
+  if (argc > 1) LittleFS.mounted = false;
+  seedMedia();
+  setup();
+
+  Session s(server, loop);
+  s.run();
+  fputs(s.log().c_str(), stdout);
+  return 0;
+}
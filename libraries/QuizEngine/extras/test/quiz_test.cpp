@@ -0,0 +1,447 @@
+// Pruebas de QuizEngine en el PC (ver Makefile).
+//  1. Recorre la sesión de session.h con cada preset y compara la
+//     transcripción con expected/, una instantánea de regresión (las
+//     diferencias deliberadas con los sketches originales, en el Makefile).
+//  2. Comprueba por separado las reglas de cada preset, incluidas las que
+//     conserva de los sketches originales.
+#include <fstream>
+#include <sstream>
+#include <QuizEngine.h>
+#include "session.h"
+
+// Mismo banco que los sketches
+const Question QUESTIONS[] = {
+  {"¿Qué partícula tiene carga negativa?", {"Protón","Neutrón","Electrón","Núcleo"}, 2},
+  {"¿Qué indica el número atómico Z?", {"Electrones + neutrones","Protones","Neutrones","Masa en gramos"}, 1},
+  {"En un átomo neutro, ¿qué se cumple?", {"p=n","p=e","n=e","Z=A"}, 1},
+  {"¿Qué es un isótopo?", {"Mismo Z, distinto A","Mismo A, distinto Z","Distinta carga","Misma masa siempre"}, 0},
+  {"A = ...", {"p + e","p + n","n + e","Z + e"}, 1},
+  {"¿Dónde se concentra casi toda la masa?", {"Corteza","Nube electrónica","Núcleo","Órbitas"}, 2},
+  {"¿Qué modelo introduce niveles de energía cuantizados?", {"Dalton","Thomson","Rutherford","Bohr"}, 3},
+  {"El experimento de Rutherford evidenció que...", {"El átomo es macizo","Hay un núcleo pequeño y denso","Los electrones están en el núcleo","No existen protones"}, 1},
+  {"¿Qué es un ion?", {"Átomo con carga neta","Átomo con muchos neutrones","Molécula neutra","Protón libre"}, 0},
+  {"Un catión es...", {"Cargado negativamente","Cargado positivamente","Sin carga","Un isótopo"}, 1},
+  {"Si un átomo gana 2 electrones, se convierte en...", {"Catión 2+","Anión 2-","Neutrón","Isótopo"}, 1},
+  {"¿Qué partícula define el elemento químico?", {"Neutrón","Electrón","Protón (Z)","Fotón"}, 2},
+  {"En la tabla periódica, los elementos se ordenan por...", {"Masa atómica","Z creciente","N creciente","Densidad"}, 1, "/media/tabla.jpg"},
+  {"¿Qué carga tiene el neutrón?", {"Positiva","Negativa","Neutra","Variable"}, 2},
+  {"¿Qué significa 'estado excitado'?", {"Menos energía que el fundamental","Más energía que el fundamental","Sin electrones","Sin núcleo"}, 1}
+};
+const uint8_t NQ = sizeof(QUESTIONS)/sizeof(QUESTIONS[0]);
+
+const char* KAJUT_ICONS[] = {"⚛️","🔬","🧪","📡","🛰️","🧠","📘","🧷","🔧","🎯","⭐","🟦","🟩","🧡","🟥","🟪","🟨","🟫","⬛","⬜"};
+const char* MEJORADO_ICONS[] = {"⚛️","🔬","🧪","📡","🛰️","🧠","📘","🧷","🔧","🎯","⭐","🟦","🟩","🟧","🟥","🟪","🟨","🟫","⬛","⬜"};
+const uint8_t NICON = sizeof(KAJUT_ICONS)/sizeof(KAJUT_ICONS[0]);
+
+static int failures = 0;
+
+#define CHECK(cond) do { \
+  if (!(cond)) { failures++; fprintf(stderr, "%s:%d: falla: %s\n", __FILE__, __LINE__, #cond); } \
+} while (0)
+
+// Valor escalar de "key" en un JSON plano (sin comillas si es texto)
+static std::string field(const String& json, const char* key) {
+  std::string k = std::string("\"") + key + "\":";
+  size_t p = json.s.find(k);
+  if (p == std::string::npos) return "<none>";
+  p += k.size();
+  if (json.s[p] == '"') {
+    size_t e = json.s.find('"', p + 1);
+    return json.s.substr(p + 1, e - p - 1);
+  }
+  size_t e = json.s.find_first_of(",}", p);
+  return json.s.substr(p, e - p);
+}
+
+static bool has(const String& json, const char* text) {
+  return json.s.find(text) != std::string::npos;
+}
+
+// ------------------ Sesión frente a expected/ ------------------
+template <class Rules>
+static std::string runSession(const char* const* icons, bool mounted) {
+  LittleFS.files.clear();
+  LittleFS.mounted = mounted;
+  fakeMillis = 1000;
+  seedMedia();
+
+  WebServer server(80);
+  std::unique_ptr<QuizGame<Rules>> game(new QuizGame<Rules>(QUESTIONS, NQ, icons, NICON, "1234"));
+  QuizServer<Rules> quiz(server, *game);
+  quiz.begin("HOST", "PLAY");
+  game->begin();
+
+  Session s(server, [&](){ game->autoAdvance(); }, QUESTION_LEAD_IN_MS);
+  s.run();
+  return s.log();
+}
+
+static void compareWithExpected(const std::string& name, const std::string& actual, bool update) {
+  std::string path = "expected/" + name + ".txt";
+  if (update) {
+    std::ofstream(path) << actual;
+    printf("actualizado %s\n", path.c_str());
+    return;
+  }
+
+  std::ifstream in(path);
+  std::stringstream expected;
+  expected << in.rdbuf();
+  if (expected.str() == actual) {
+    printf("ok %s\n", name.c_str());
+    return;
+  }
+
+  failures++;
+  std::ofstream("out/" + name + ".txt") << actual;
+  std::istringstream e(expected.str()), a(actual);
+  std::string le, la;
+  for (int line = 1; ; line++) {
+    bool me = (bool)std::getline(e, le), ma = (bool)std::getline(a, la);
+    if (!me && !ma) break;
+    if (!me || !ma || le != la) {
+      fprintf(stderr, "%s:%d difiere\n  esperado: %s\n  obtenido: %s\n(transcripción completa en out/%s.txt)\n",
+              path.c_str(), line, me ? le.c_str() : "<fin>", ma ? la.c_str() : "<fin>", name.c_str());
+      break;
+    }
+  }
+}
+
+// ------------------ Reglas por preset ------------------
+template <class Rules>
+static QuizGame<Rules>* newGame(bool mounted = false) {
+  LittleFS.files.clear();
+  LittleFS.mounted = mounted;
+  fakeMillis = 1000;
+  QuizGame<Rules>* g = new QuizGame<Rules>(QUESTIONS, NQ, KAJUT_ICONS, NICON, "1234");
+  g->begin();
+  return g;
+}
+
+// Deja pasar la cuenta previa de la pregunta recién lanzada
+static void skipLeadIn() { fakeMillis += QUESTION_LEAD_IN_MS; }
+
+static void testScoring() {
+  typedef KajutRules::Scoring S;
+  CHECK(S::points(20000, 20000, 1) == 550);
+  CHECK(S::points(0, 20000, 0) == 100);
+  CHECK(S::points(5000, 20000, 2) == 300);
+
+  std::unique_ptr<QuizGame<KajutRules>> g(newGame<KajutRules>());
+  g->join("1234", "Ana", "");
+  g->start();
+  CHECK(field(g->answer(1, 2), "err") == "La pregunta aún no ha empezado");
+  skipLeadIn();
+  fakeMillis += 800;
+  g->answer(1, 2);                                   // quedan 19,2 s, racha 1
+  CHECK(field(g->state(1), "me_score") == "534");    // 100 + 19200*400/20000 + 50
+  g->next();
+  skipLeadIn();
+  fakeMillis += 5000;
+  g->answer(1, 1);                                   // quedan 15 s, racha 2
+  CHECK(field(g->state(1), "me_score") == "1034");   // + 100 + 300 + 100
+  g->next();
+  skipLeadIn();
+  g->answer(1, 0);                                   // incorrecta: 0 puntos y racha a 0
+  String s = g->state(1);
+  CHECK(field(s, "me_score") == "1034");
+  CHECK(field(s, "me_streak") == "0");
+}
+
+static void testPollHints() {
+  std::unique_ptr<QuizGame<KajutRules>> g(newGame<KajutRules>());
+  g->join("1234", "Ana", "");
+  CHECK(field(g->state(0), "next_poll_ms") == "500");
+  fakeMillis += 2000;
+  CHECK(field(g->state(0), "next_poll_ms") == "1500");  // en espera, el intervalo crece
+  fakeMillis += 60000;
+  CHECK(field(g->state(0), "next_poll_ms") == "4000");  // hasta POLL_IDLE_MAX_MS
+
+  for (int i=1;i<50;i++) g->join("1234", "p", "");
+  g->start();
+  String s = g->state(0);
+  CHECK(field(s, "starts_in_ms") == "4000");
+  CHECK(field(s, "time_left_ms") == "20000");
+  CHECK(field(s, "next_poll_ms") == "1250");         // 50 jugadores a 40 peticiones/s
+  fakeMillis += 3500;
+  CHECK(field(g->state(0), "next_poll_ms") == "500");   // no más allá de la cuenta previa
+  fakeMillis += 500;
+  s = g->state(0);
+  CHECK(field(s, "starts_in_ms") == "0");
+  CHECK(field(s, "time_left_ms") == "20000");
+  fakeMillis += 15000;                               // últimos 5 s: con carga, tope de 1 s
+  CHECK(field(g->state(0), "next_poll_ms") == "1000");
+  fakeMillis += 4800;
+  CHECK(field(g->state(0), "next_poll_ms") == "250");   // y no más allá del final
+
+  g->reveal();
+  CHECK(field(g->state(0), "next_poll_ms") == "1250");
+  fakeMillis += 10000;
+  CHECK(field(g->state(0), "next_poll_ms") == "4000");
+}
+
+static void testNextKajut() {
+  std::unique_ptr<QuizGame<KajutRules>> g(newGame<KajutRules>());
+  g->join("1234", "Ana", "");
+  g->start();
+  for (int i=1;i<NQ;i++) CHECK(g->next() == "{\"ok\":true}");
+  CHECK(field(g->state(1), "q_index") == "14");
+
+  CHECK(g->next() == "{\"ok\":true,\"finished\":true}");
+  String s = g->state(1);
+  CHECK(field(s, "phase") == "4");
+  CHECK(field(s, "final") == "true");
+  fakeMillis += 10000;
+  CHECK(field(g->state(1), "next_poll_ms") == "4000");  // la clasificación final espera al host
+
+  CHECK(g->next() == "{\"ok\":true}");               // tras la final, vuelve a empezar
+  s = g->state(1);
+  CHECK(field(s, "phase") == "2");
+  CHECK(field(s, "q_index") == "0");
+}
+
+static void testNextMejorado() {
+  std::unique_ptr<QuizGame<MejoradoRules>> g(newGame<MejoradoRules>());
+  g->join("1234", "Ana", "");
+  g->start();
+  for (int i=1;i<NQ;i++) g->next();
+  CHECK(field(g->state(1), "q_index") == "14");
+
+  CHECK(g->next() == "{\"ok\":true}");               // sin clasificación final: vuelve a la 1
+  String s = g->state(1);
+  CHECK(field(s, "phase") == "2");
+  CHECK(field(s, "q_index") == "0");
+  CHECK(field(s, "final") == "false");
+}
+
+static void testStartKajut() {
+  std::unique_ptr<QuizGame<KajutRules>> g(newGame<KajutRules>());
+  g->join("1234", "Ana", "");
+  g->start();
+  skipLeadIn();
+  g->answer(1, 2);
+  g->next();
+  CHECK(field(g->state(1), "me_score") != "0");
+
+  g->start();                                        // nueva partida: pregunta 1 y marcadores a cero
+  String s = g->state(1);
+  CHECK(field(s, "q_index") == "0");
+  CHECK(field(s, "me_score") == "0");
+  CHECK(field(s, "me_streak") == "0");
+}
+
+static void testStartMejorado() {
+  std::unique_ptr<QuizGame<MejoradoRules>> g(newGame<MejoradoRules>());
+  g->join("1234", "Ana", "");
+  g->start();
+  skipLeadIn();
+  g->answer(1, 2);
+  g->next();
+  skipLeadIn();
+  g->answer(1, 1);
+  std::string score = field(g->state(1), "me_score");
+  CHECK(score != "0");
+
+  g->start();                                        // relanza la pregunta actual
+  String s = g->state(1);
+  CHECK(field(s, "q_index") == "1");
+  CHECK(field(s, "me_score") == score);
+  CHECK(field(s, "me_answered") == "false");
+  CHECK(field(s, "time_left_ms") == "20000");
+}
+
+static void testPresetFields() {
+  std::unique_ptr<QuizGame<KajutRules>> k(newGame<KajutRules>());
+  k->join("1234", "Ana", "");
+  String s = k->state(1);
+  CHECK(!has(s, "\"me_status\""));
+  CHECK(has(s, "\"leaderboard\":[{\"name\":\"Ana\",\"icon\":\"🔬\",\"score\":0}]"));
+
+  std::unique_ptr<QuizGame<MejoradoRules>> m(newGame<MejoradoRules>());
+  m->join("1234", "Ana", "");
+  s = m->state(1);
+  CHECK(field(s, "me_status") == "Esperando a que el host inicie...");
+  CHECK(has(s, "\"leaderboard\":[{\"name\":\"Ana\",\"icon\":\"🔬\",\"score\":0,\"streak\":0}]"));
+}
+
+static void testJoinWindow() {
+  std::unique_ptr<QuizGame<KajutRules>> k(newGame<KajutRules>());
+  CHECK(field(k->openJoin(), "ok") == "false");
+  CHECK(field(k->state(0), "phase") == "0");
+
+  std::unique_ptr<QuizGame<MejoradoRules>> m(newGame<MejoradoRules>());
+  CHECK(m->openJoin() == "{\"ok\":true}");
+  String s = m->state(0);
+  CHECK(field(s, "phase") == "1");
+  CHECK(field(s, "time_left_ms") == "10000");
+  m->join("1234", "Ana", "");
+  CHECK(field(m->state(1), "me_status") == "¡Prepárate! La ronda comienza pronto...");
+
+  fakeMillis += 9999;
+  m->autoAdvance();
+  CHECK(field(m->state(0), "phase") == "1");
+  fakeMillis += 1;
+  m->autoAdvance();                                  // agotada la ventana, vuelve al lobby
+  s = m->state(0);
+  CHECK(field(s, "phase") == "0");
+  CHECK(field(s, "time_left_ms") == "0");
+
+  m->start();
+  CHECK(field(m->openJoin(), "ok") == "false");      // solo desde el lobby
+}
+
+static void testAnswerRounds() {
+  std::unique_ptr<QuizGame<MejoradoRules>> g(newGame<MejoradoRules>());
+  g->join("1234", "Ana", "");
+  g->join("1234", "Bob", "");
+  g->start();
+  skipLeadIn();
+  g->answer(1, 2);
+  g->answer(2, 0);
+  String s = g->state(1);                            // todos han respondido: REVEAL
+  CHECK(field(s, "phase") == "3");
+  CHECK(field(s, "me_answered") == "true");
+  CHECK(field(s, "me_correct") == "true");
+  CHECK(field(s, "me_status") == "¡Correcto! 🎉");
+  CHECK(field(g->state(2), "me_correct") == "false");
+
+  g->next();                                         // nueva pregunta: nadie ha respondido aún
+  s = g->state(1);
+  CHECK(field(s, "players_answered") == "0");
+  CHECK(field(s, "me_answered") == "false");
+  CHECK(field(s, "me_correct") == "false");
+  skipLeadIn();
+  g->answer(1, 1);
+  CHECK(field(g->state(1), "phase") == "2");         // falta Bob
+  fakeMillis += 20000;
+  s = g->state(1);                                   // tiempo agotado
+  CHECK(field(s, "me_correct") == "true");
+  CHECK(field(g->state(2), "me_status") == "Se acabó el tiempo ⏰");
+}
+
+static void testRevealOnlyFromQuestion() {
+  std::unique_ptr<QuizGame<KajutRules>> g(newGame<KajutRules>());
+  g->join("1234", "Ana", "");
+  CHECK(field(g->reveal(), "ok") == "false");        // desde el lobby no hay nada que revelar
+  CHECK(field(g->state(0), "phase") == "0");
+
+  // Con piloto, un reveal en el lobby saltaba la pregunta 1
+  g->setAutopilot(true);
+  g->reveal();
+  fakeMillis += 10000;
+  g->autoAdvance();
+  CHECK(field(g->state(0), "phase") == "0");
+  g->start();
+  CHECK(field(g->state(0), "q_index") == "0");
+
+  CHECK(g->reveal() == "{\"ok\":true}");
+  CHECK(field(g->state(0), "phase") == "3");
+  CHECK(field(g->reveal(), "ok") == "false");        // ya revelada
+}
+
+static void testProfiles() {
+  std::unique_ptr<QuizGame<MejoradoRules>> g(newGame<MejoradoRules>(true));
+  g->join("1234", "Ana", "  ANA   García ");
+  g->start();
+  skipLeadIn();
+  g->answer(1, 2);
+  for (int i=1;i<NQ;i++) g->next();
+  CHECK(field(g->league(), "profiles") == "0");      // nada guardado a mitad de partida
+
+  g->reveal();                                       // última pregunta revelada: se guarda
+  String l = g->league();
+  CHECK(field(l, "profiles") == "1");
+  CHECK(field(l, "name") == "Ana");                  // nombre visible, no la clave
+  CHECK(field(l, "games") == "1");
+  CHECK(field(l, "score") == "550");
+
+  g->next();                                         // vuelta a la pregunta 1: otra partida
+  skipLeadIn();
+  g->answer(1, 2);
+  for (int i=1;i<NQ;i++) g->next();
+  g->reveal();
+  l = g->league();
+  CHECK(field(l, "games") == "2");
+  CHECK(field(l, "score") == "1150");                // 550 + (100 + 400 + 100) con racha 2
+
+  // El mismo token con otro nombre es el mismo alumno; el nombre se actualiza
+  g->reset();
+  String j = g->join("1234", "Anita", "ana garcía");
+  CHECK(has(j, "\"profile\":{\"name\":\"Ana\",\"games\":2"));
+  g->start();
+  skipLeadIn();
+  g->answer(1, 2);
+  g->saveProfiles();
+  l = g->league();
+  CHECK(field(l, "profiles") == "1");
+  CHECK(field(l, "name") == "Anita");
+  CHECK(field(l, "games") == "3");
+}
+
+static void testProfileGames() {
+  // Kajut con 2 preguntas, jugada dos veces hasta la clasificación final
+  LittleFS.files.clear();
+  LittleFS.mounted = true;
+  fakeMillis = 1000;
+  std::unique_ptr<QuizGame<KajutRules>> g(new QuizGame<KajutRules>(QUESTIONS, 2, KAJUT_ICONS, NICON, "1234"));
+  g->begin();
+  g->join("1234", "Ana", "");
+  g->join("1234", "ana", "");                        // misma clave en otra ranura (recarga)
+  g->start();
+  for (int game=0;game<2;game++) {
+    for (int q=0;q<2;q++) {
+      skipLeadIn();
+      g->answer(1, QUESTIONS[q].correct);
+      g->answer(2, QUESTIONS[q].correct);
+      CHECK(field(g->state(0), "phase") == "3");     // todos respondieron: REVEAL
+      g->next();
+    }
+    CHECK(field(g->state(0), "final") == "true");
+    String l = g->league();
+    CHECK(field(l, "games") == std::to_string(game + 1));
+    g->next();                                       // tras la final, nueva partida
+  }
+  String l = g->league();
+  CHECK(field(l, "profiles") == "1");
+  CHECK(field(l, "score") == "5000");                // 2 ranuras x (550 + 600 + 650 + 700), racha 1..4
+}
+
+static void testMediaScript() {
+  std::unique_ptr<QuizGame<KajutRules>> g(newGame<KajutRules>());
+  WebServer server(80);
+  QuizServer<KajutRules> quiz(server, *g);
+  quiz.begin("HOST", "PLAY");
+  server.routes["/media.js"]();
+  CHECK(server.out.find("200 application/javascript") == 0);
+  CHECK(server.out.find("function updateMedia(s, imgEl, audEl)") != std::string::npos);
+}
+
+int main(int argc, char** argv) {
+  bool update = argc > 1 && std::string(argv[1]) == "--update";
+
+  compareWithExpected("kajut", runSession<KajutRules>(KAJUT_ICONS, true), update);
+  compareWithExpected("kajut-nofs", runSession<KajutRules>(KAJUT_ICONS, false), update);
+  compareWithExpected("mejorado", runSession<MejoradoRules>(MEJORADO_ICONS, true), update);
+  compareWithExpected("mejorado-nofs", runSession<MejoradoRules>(MEJORADO_ICONS, false), update);
+
+  testScoring();
+  testPollHints();
+  testNextKajut();
+  testNextMejorado();
+  testStartKajut();
+  testStartMejorado();
+  testPresetFields();
+  testJoinWindow();
+  testAnswerRounds();
+  testRevealOnlyFromQuestion();
+  testProfiles();
+  testProfileGames();
+  testMediaScript();
+
+  if (failures) {
+    fprintf(stderr, "%d fallo(s)\n", failures);
+    return 1;
+  }
+  printf("todas las pruebas pasan\n");
+  return 0;
+}
@@ -0,0 +1,138 @@
+#pragma once
+// Sesión guionizada común. La recorren QuizServer/QuizGame en quiz_test.cpp,
+// que compara la transcripción de cada preset con expected/<preset>.txt, y
+// los sketches anteriores a la biblioteca en legacy_main.cpp (make reference).
+#include <initializer_list>
+#include <utility>
+#include <WebServer.h>
+#include <LittleFS.h>
+
+typedef std::initializer_list<std::pair<const char*, const char*>> KeyValues;
+
+// Imagen de la pregunta 13 ("/media/tabla.jpg"), varias veces MEDIA_MAX_SLICE
+inline void seedMedia() {
+  File f = LittleFS.open("/media/tabla.jpg", "w");
+  std::vector<uint8_t> b(40000);
+  for (size_t i=0;i<b.size();i++) b[i] = (uint8_t)i;
+  f.write(b.data(), b.size());
+}
+
+class Session {
+public:
+  // leadInMs: cuenta previa de cada pregunta (0 en los sketches anteriores)
+  Session(WebServer& server, std::function<void()> loop, uint32_t leadInMs = 0)
+      : server_(server), loop_(loop), leadInMs_(leadInMs) {}
+
+  const std::string& log() const { return log_; }
+
+  void req(const char* path, KeyValues args = {}, KeyValues headers = {}) {
+    server_.args.clear();
+    server_.headers.clear();
+    server_.out.clear();
+    fakeWire.clear();
+    for (auto& a : args) server_.args[a.first] = a.second;
+    for (auto& h : headers) server_.headers[h.first] = h.second;
+
+    char t[32];
+    snprintf(t, sizeof(t), "t=%u ", (unsigned)fakeMillis);
+    log_ += t;
+    log_ += path;
+    for (auto& a : args) log_ += std::string(" ") + a.first + "=" + a.second;
+    for (auto& h : headers) log_ += std::string(" <") + h.first + ":" + h.second + ">";
+
+    auto it = server_.routes.find(path);
+    if (it == server_.routes.end()) { log_ += " -> NOROUTE\n"; return; }
+    it->second();
+    log_ += " -> " + server_.out;
+    if (!fakeWire.empty()) log_ += " wire=" + std::to_string(fakeWire.size());
+    log_ += "\n";
+  }
+
+  void tick(uint32_t ms) {
+    fakeMillis += ms;
+    loop_();
+  }
+
+  void run() {
+    req("/");
+    req("/api/state");
+    req("/api/join", {{"pin","9"},{"name","x"}});
+    req("/api/join", {{"pin","1234"},{"name","   "}});
+    req("/api/join", {{"pin"," 1234 "},{"name","  Ana  "}});
+    req("/api/join", {{"pin","1234"},{"name","Bob \"el\" \\ Grande Largo Nombre"}});
+    req("/api/join", {{"pin","1234"},{"name","Carla"},{"token","  Carla   LOPEZ "}});
+    req("/api/state", {{"pid","1"}});
+    req("/api/answer", {{"pid","1"}});
+    req("/api/answer", {{"pid","1"},{"opt","1"}});
+    req("/api/host/start");
+
+    // Más rondas que preguntas: cubre el final de la partida y lo que sigue
+    for (int round = 0; round < 18; round++) {
+      req("/api/state", {{"pid","1"}});
+      tick(leadInMs_ + 1500 + round * 300);
+      req("/api/answer", {{"pid","1"},{"opt", round % 2 ? "1" : "2"}});
+      req("/api/answer", {{"pid","1"},{"opt","2"}});
+      req("/api/answer", {{"pid","2"},{"opt", round % 3 ? "1" : "0"}});
+      req("/api/answer", {{"pid","9"},{"opt","1"}});
+      req("/api/answer", {{"pid","2"},{"opt","7"}});
+      req("/api/state", {{"pid","2"}});
+      if (round % 4 == 0) {
+        tick(20000);
+        req("/api/state", {{"pid","3"}});
+      } else if (round % 4 == 1) {
+        req("/api/answer", {{"pid","3"},{"opt","1"}});
+        req("/api/state", {{"pid","3"}});
+      } else {
+        req("/api/host/reveal");
+      }
+      req("/api/state", {{"pid","3"}});
+      req("/api/state");
+      req("/api/host/next");
+      req("/api/state", {{"pid","1"}});
+    }
+
+    req("/api/media", {{"q","12"},{"t","img"}});
+    req("/api/media", {{"q","12"},{"t","img"}}, {{"Range","bytes=0-"}});
+    req("/api/media", {{"q","12"},{"t","img"}}, {{"Range","bytes=39000-"}});
+    req("/api/media", {{"q","12"},{"t","img"}}, {{"Range","bytes=-500"}});
+    req("/api/media", {{"q","12"},{"t","img"}}, {{"Range","bytes=50000-"}});
+    req("/api/media", {{"q","12"},{"t","img"}}, {{"If-None-Match","\"x\""}});
+    req("/api/media", {{"q","12"},{"t","aud"}});
+    req("/api/media", {{"q","99"}});
+    req("/api/media");
+
+    // Ráfaga de sondeos: carga alta
+    for (int i=0;i<120;i++) { fakeMillis += 10; req("/api/state"); }
+
+    req("/api/host/autopilot");
+    req("/api/host/autopilot", {{"on","1"},{"reveal_ms","-5"},{"board_ms","99999"}});
+    req("/api/host/autopilot", {{"reveal_ms","3000"},{"board_ms","0"}});
+    req("/api/host/reveal");
+    for (int i=0;i<40;i++) {
+      tick(700);
+      req("/api/state", {{"pid","2"}});
+      if (i % 5 == 0) req("/api/answer", {{"pid","2"},{"opt","1"}});
+    }
+    req("/api/host/autopilot", {{"board_ms","2000"}});
+    for (int i=0;i<80;i++) { tick(900); req("/api/state", {{"pid","1"}}); }
+    req("/api/host/autopilot", {{"on","0"}});
+
+    req("/api/host/league");
+    req("/api/host/save");
+    req("/api/host/start");
+    req("/api/host/league");
+    req("/api/host/reset");
+    req("/api/state", {{"pid","1"}});
+    req("/api/host/league");
+    req("/api/join", {{"pin","1234"},{"name","carla"}});
+    req("/api/join", {{"pin","1234"},{"name","zz"},{"token","ana"}});
+    for (int i=0;i<52;i++) req("/api/join", {{"pin","1234"},{"name","p"}});
+    req("/api/state");
+  }
+
+private:
+  WebServer& server_;
+  std::function<void()> loop_;
+  uint32_t leadInMs_;
+  std::string log_;
+};
@@ -0,0 +1,69 @@
+#pragma once
+// Sustituto mínimo del core de Arduino para compilar QuizEngine en el PC.
+// millis() lee un reloj falso (fakeMillis) que avanza el propio test.
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define HEX 16
+#define DEC 10
+#define PROGMEM
+#define FPSTR(p) ((const char*)(p))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+extern uint32_t fakeMillis;
+inline uint32_t millis() { return fakeMillis; }
+inline uint32_t micros() { return 0; }
+inline void yield() {}
+
+class String {
+public:
+  std::string s;
+  String() {}
+  String(const char* c) : s(c ? c : "") {}
+  String(const std::string& c) : s(c) {}
+  String(char c) : s(1, c) {}
+  explicit String(unsigned char v, unsigned char base=10) : String((unsigned long)v, base) {}
+  explicit String(int v, unsigned char base=10) : String((long)v, base) {}
+  explicit String(unsigned int v, unsigned char base=10) : String((unsigned long)v, base) {}
+  explicit String(long v, unsigned char base=10) { char b[24]; snprintf(b, sizeof(b), base == 16 ? "%lx" : "%ld", v); s = b; }
+  explicit String(unsigned long v, unsigned char base=10) { char b[24]; snprintf(b, sizeof(b), base == 16 ? "%lx" : "%lu", v); s = b; }
+  unsigned length() const { return s.size(); }
+  void reserve(unsigned n) { s.reserve(n); }
+  char operator[](unsigned i) const { return s[i]; }
+  String& operator+=(const String& o) { s += o.s; return *this; }
+  String& operator+=(const char* o) { s += o; return *this; }
+  String& operator+=(char c) { s += c; return *this; }
+  bool operator==(const String& o) const { return s == o.s; }
+  bool operator==(const char* o) const { return s == o; }
+  bool operator!=(const String& o) const { return s != o.s; }
+  bool operator!=(const char* o) const { return s != o; }
+  void trim() {
+    size_t a = s.find_first_not_of(" \t\r\n");
+    if (a == std::string::npos) { s.clear(); return; }
+    s = s.substr(a, s.find_last_not_of(" \t\r\n") - a + 1);
+  }
+  String substring(unsigned a) const { return a < s.size() ? s.substr(a) : ""; }
+  String substring(unsigned a, unsigned b) const { return a < s.size() && b > a ? s.substr(a, b - a) : ""; }
+  long toInt() const { return atol(s.c_str()); }
+  int indexOf(char c, unsigned from=0) const { size_t p = s.find(c, from); return p == std::string::npos ? -1 : (int)p; }
+  bool startsWith(const char* p) const { return s.compare(0, strlen(p), p) == 0; }
+  const char* c_str() const { return s.c_str(); }
+};
+inline String operator+(const String& a, const String& b) { return String(a.s + b.s); }
+inline String operator+(const String& a, const char* b) { return String(a.s + b); }
+inline String operator+(const char* a, const String& b) { return String(std::string(a) + b.s); }
+
+struct SerialT {
+  void begin(int) {}
+  template <class T> void print(const T&) {}
+  template <class T> void println(const T&) {}
+};
+extern SerialT Serial;
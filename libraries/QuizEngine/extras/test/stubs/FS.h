@@ -0,0 +1,46 @@
+#pragma once
+#include "Arduino.h"
+
+// Sistema de ficheros en memoria: cada ruta es un vector de bytes compartido
+namespace fs {
+typedef std::shared_ptr<std::vector<uint8_t>> Blob;
+
+class File {
+public:
+  Blob d;
+  size_t pos = 0;
+  operator bool() const { return (bool)d; }
+  size_t size() const { return d ? d->size() : 0; }
+  bool seek(uint32_t p) { if (!d || p > d->size()) return false; pos = p; return true; }
+  size_t read(uint8_t* b, size_t n) {
+    if (!d) return 0;
+    size_t k = std::min(n, d->size() - pos);
+    memcpy(b, d->data() + pos, k);
+    pos += k;
+    return k;
+  }
+  size_t write(const uint8_t* b, size_t n) {
+    if (!d) return 0;
+    if (pos + n > d->size()) d->resize(pos + n);
+    memcpy(d->data() + pos, b, n);
+    pos += n;
+    return n;
+  }
+  void close() { d.reset(); }
+  bool isDirectory() { return false; }
+  time_t getLastWrite() { return 1234; }
+};
+
+class FS {
+public:
+  std::map<std::string, Blob> files;
+  File open(const char* path, const char* mode="r") {
+    File f;
+    if (mode[0] == 'w') { f.d = std::make_shared<std::vector<uint8_t>>(); files[path] = f.d; return f; }
+    auto i = files.find(path);
+    if (i != files.end()) f.d = i->second;
+    return f;
+  }
+};
+}
+using fs::File;
@@ -0,0 +1,9 @@
+#pragma once
+#include "FS.h"
+
+class LittleFSFS : public fs::FS {
+public:
+  bool mounted = true;   // false simula una partición que no monta
+  bool begin(bool formatOnFail=false) { return mounted; }
+};
+extern LittleFSFS LittleFS;
@@ -0,0 +1,27 @@
+#pragma once
+#include "WiFi.h"
+
+// Guarda las rutas registradas y vuelca cada respuesta en texto en `out`
+class WebServer {
+public:
+  std::map<std::string, std::function<void()>> routes;
+  std::map<std::string, std::string> args, headers;
+  std::string out;
+
+  WebServer(int) {}
+  void begin() {}
+  void handleClient() {}
+  void on(const String& uri, std::function<void()> fn) { routes[uri.s] = fn; }
+  void collectHeaders(const char* names[], size_t n) {}
+
+  bool hasArg(const String& n) { return args.count(n.s) > 0; }
+  String arg(const String& n) { auto i = args.find(n.s); return i == args.end() ? String() : String(i->second); }
+  String header(const String& n) { auto i = headers.find(n.s); return i == headers.end() ? String() : String(i->second); }
+
+  void sendHeader(const String& k, const String& v, bool first=false) { out += "[" + k.s + ":" + v.s + "]"; }
+  void setContentLength(size_t n) { out += "[len:" + std::to_string(n) + "]"; }
+  void send(int code, const char* type, const String& body) { out += std::to_string(code) + " " + type + " " + body.s; }
+  void send(int code, const char* type, const char* body) { out += std::to_string(code) + " " + type + " " + body; }
+  void send(int code) { out += std::to_string(code); }
+  WiFiClient client() { return WiFiClient(); }
+};
@@ -0,0 +1,20 @@
+#pragma once
+#include "Arduino.h"
+
+#define WIFI_AP 2
+struct IPAddress {};
+
+// Lo que se escribe directamente en el socket (cuerpos de /api/media)
+extern std::string fakeWire;
+
+struct WiFiClient {
+  size_t write(const uint8_t* d, size_t n) { fakeWire.append((const char*)d, n); return n; }
+  bool connected() { return true; }
+};
+
+struct WiFiT {
+  void mode(int) {}
+  bool softAP(const char*, const char*) { return true; }
+  IPAddress softAPIP() { return IPAddress(); }
+};
+extern WiFiT WiFi;
@@ -0,0 +1,9 @@
+#include "Arduino.h"
+#include "WiFi.h"
+#include "LittleFS.h"
+
+uint32_t fakeMillis = 0;
+std::string fakeWire;
+SerialT Serial;
+WiFiT WiFi;
+LittleFSFS LittleFS;
@@ -0,0 +1,14 @@
+#pragma once
+// Motor común de los sketches de quiz: un único QuizGame<Rules> parametrizado
+// por un preset de reglas (KajutRules, MejoradoRules o uno propio) y
+// QuizServer<Rules>, que publica su API en un WebServer.
+//
+// Para compilar los sketches, usar la raíz del repositorio como carpeta de
+// sketches del IDE de Arduino o pasar --libraries libraries/ a arduino-cli
+// (ver README.md).
+#include "QuizTypes.h"
+#include "QuizPolicies.h"
+#include "QuizMedia.h"
+#include "QuizProfiles.h"
+#include "QuizGame.h"
+#include "QuizServer.h"
@@ -0,0 +1,523 @@
+#pragma once
+#include <LittleFS.h>
+#include "QuizTypes.h"
+#include "QuizPolicies.h"
+#include "QuizMedia.h"
+#include "QuizProfiles.h"
+
+// ------------------ Sondeo adaptativo ------------------
+// El servidor sugiere a los clientes cuándo volver a consultar /api/state.
+// La carga se estima con el número de jugadores, no con la tasa medida (que
+// depende de la propia sugerencia y haría oscilar el intervalo): se alarga
+// lo justo para que todos juntos no pasen de POLL_LOAD_RPS, con un tope
+// por fase. Nunca se duerme más allá del siguiente cambio previsible (fin
+// del tiempo, fin de la cuenta previa o del piloto automático).
+// En las fases de espera (lobby, REVEAL, clasificación) el intervalo crece
+// con el tiempo que lleva la fase hasta POLL_IDLE_MAX_MS. Como el host puede
+// lanzar una pregunta en cualquier momento, cada pregunta empieza con una
+// cuenta previa de QUESTION_LEAD_IN_MS: todos la ven antes de poder responder.
+const uint32_t POLL_FAST_MS = 250;
+const uint32_t POLL_WAIT_MS = 500;          // primera espera tras un cambio de fase
+const uint32_t POLL_IDLE_MAX_MS = 4000;
+const uint32_t POLL_QUESTION_MS = 750;
+const uint32_t POLL_SLOW_MS = 5000;
+const uint32_t POLL_FINAL_WINDOW_MS = 5000;
+const uint32_t POLL_FINAL_MAX_MS = 1000;    // tope en los últimos segundos de la pregunta
+const uint16_t POLL_LOAD_RPS = 40;   // peticiones/s que se reparten entre los jugadores
+const uint32_t QUESTION_LEAD_IN_MS = POLL_IDLE_MAX_MS;
+
+// ------------------ Motor del juego ------------------
+// Estado y reglas de una partida, sin HTTP: cada operación devuelve el JSON
+// que QuizServer envía tal cual. Rules es un preset de QuizPolicies.h.
+template <class Rules>
+class QuizGame {
+public:
+  typedef typename Rules::Scoring Scoring;
+
+  QuizGame(const Question* questions, uint8_t count,
+           const char* const* icons, uint8_t iconCount, const char* pin)
+      : questions_(questions), icons_(icons), nicons_(iconCount), pin_(pin),
+        livePayload_(&payloadBuf_[0]), stagedPayload_(&payloadBuf_[1]) {
+    uint8_t maxQ = Rules::kMaxQuestions;
+    nq_ = count > maxQ ? maxQ : count;
+  }
+
+  // Monta LittleFS, indexa los medios, abre los perfiles y prepara la pregunta 1
+  void begin() {
+    bool fsReady = LittleFS.begin(true);
+    media_.index(questions_, nq_, fsReady);
+    profiles_.open(fsReady);
+    loadQuestion(0);
+    phaseStartMs_ = millis();
+  }
+
+  void serveMedia(WebServer& server, int q, uint8_t kind) { media_.serve(server, q, kind); }
+
+  // ---- Transiciones automáticas (llamar desde loop() y en cada /api/state) ----
+  void autoAdvance() {
+    if (shouldAdvanceFromQuestion()) {
+      enterReveal();
+      return;
+    }
+    if (Rules::kJoinPhase && phase_ == JOINING && timeLeftMs() == 0) {
+      phase_ = LOBBY;
+      return;
+    }
+    if (!autopilot_ || autopilotLeftMs() > 0) return;
+
+    if (phase_ == REVEAL) {
+      if ((uint8_t)(currentQ_ + 1) >= nq_ || autoBoardMs_ > 0) enterLeaderboard();
+      else flipToQuestion(currentQ_ + 1);
+    } else if (phase_ == LEADERBOARD && !isFinalBoard()) {
+      flipToQuestion(currentQ_ + 1);
+    }
+  }
+
+  // ---- API de jugador ----
+  String join(String pin, String name, const String& token) {
+    name.trim(); pin.trim();
+    if (pin != pin_) return "{\"ok\":false,\"err\":\"PIN incorrecto\"}";
+    if (name.length() < 1) return "{\"ok\":false,\"err\":\"Nombre vacío\"}";
+
+    int slot = -1;
+    for (int i=0;i<Rules::kMaxPlayers;i++) if (!players_[i].used) { slot=i; break; }
+    if (slot < 0) return "{\"ok\":false,\"err\":\"Sala llena\"}";
+
+    Player& p = players_[slot];
+    p = Player();
+    p.used = true;
+    p.id = nextPlayerId_++;
+    p.name = name.substring(0, Rules::kNameLen);
+    p.icon = p.id % nicons_;
+    p.joinedThisRound = true;
+    p.profileKey = normalizeKey(token.length() ? token : name);
+    lbDirty_ = true;
+
+    String body = "{\"ok\":true,\"pid\":" + String(p.id) +
+                  ",\"name\":\"" + jsonEscape(p.name) + "\"" +
+                  ",\"icon\":\"" + String(icons_[p.icon]) + "\"";
+    ProfileRec rec;
+    if (profiles_.lookup(p.profileKey, rec)) body += ",\"profile\":" + profileJson(rec);
+    body += "}";
+    return body;
+  }
+
+  String answer(uint16_t pid, int opt) {
+    Player* p = findPlayer(pid);
+    if (!p) return "{\"ok\":false,\"err\":\"Jugador no existe\"}";
+    if (phase_ != QUESTION) return "{\"ok\":false,\"err\":\"No es momento de responder\"}";
+    if (leadInLeftMs() > 0) return "{\"ok\":false,\"err\":\"La pregunta aún no ha empezado\"}";
+    if (opt < 0 || opt > 3) return "{\"ok\":false,\"err\":\"Opción inválida\"}";
+    if (answeredNow(*p)) return "{\"ok\":true}";
+
+    p->answeredRound = round_;
+    p->answer = (int8_t)opt;
+    p->correct = (opt == questions_[currentQ_].correct);
+    p->answerTime = millis();
+
+    uint32_t gained = 0;
+    if (p->correct) {
+      p->streak++;
+      gained = Scoring::points(timeLeftMs(), Rules::kQuestionMs, p->streak);
+    } else {
+      p->streak = 0;
+    }
+    p->score += (int32_t)gained;
+    lbDirty_ = true;
+
+    p->profGained += gained;
+    p->profAnswered++;
+    if (p->correct) p->profCorrect++;
+    if ((uint32_t)p->streak > p->bestStreak) p->bestStreak = (uint16_t)p->streak;
+
+    return "{\"ok\":true}";
+  }
+
+  String state(uint16_t pid) {
+    autoAdvance();
+
+    Player* me = pid ? findPlayer(pid) : nullptr;
+
+    uint32_t tl = timeLeftMs();
+    bool qVisible = (phase_ == QUESTION || phase_ == REVEAL);
+    int16_t following = followingQ();
+
+    String body = "{";
+    body += "\"pin\":\"" + String(pin_) + "\",";
+    body += "\"players\":" + String(playerCount()) + ",";
+    body += "\"players_answered\":" + String(playersAnswered()) + ",";
+    body += "\"phase\":" + String((uint8_t)phase_) + ",";
+    body += "\"time_left_ms\":" + String(tl) + ",";
+    body += "\"starts_in_ms\":" + String(leadInLeftMs()) + ",";
+    body += "\"next_poll_ms\":" + String(nextPollMs(tl)) + ",";
+    body += "\"q_total\":" + String(nq_) + ",";
+    body += "\"q_visible\":" + String(qVisible ? "true" : "false") + ",";
+    body += "\"final\":" + String(isFinalBoard() ? "true" : "false") + ",";
+    body += "\"autopilot\":" + String(autopilot_ ? "true" : "false") + ",";
+    body += *livePayload_;   // fragmento preparado durante REVEAL
+    if (phase_ == REVEAL && following >= 0) {
+      body += "\"next_img\":\"" + media_.url((uint8_t)following, 0) + "\",";
+      body += "\"next_aud\":\"" + media_.url((uint8_t)following, 1) + "\",";
+    }
+    body += "\"leaderboard\":" + leaderboardSnapshot();
+
+    if (me) {
+      body += ",\"me_score\":" + String(me->score);
+      body += ",\"me_streak\":" + String(me->streak);
+      bool answered = answeredNow(*me);
+      body += ",\"me_answered\":" + String(answered ? "true":"false");
+      body += ",\"me_correct\":" + String(answered && me->correct ? "true":"false");
+      if (Rules::kStatusText) body += ",\"me_status\":\"" + jsonEscape(statusText(*me)) + "\"";
+    }
+
+    body += "}";
+    return body;
+  }
+
+  // ---- API del host ----
+  String next() {
+    if (Rules::kWrapOnNext) {
+      uint8_t q = (currentQ_ + 1) % nq_;
+      // Sin clasificación final: cada vuelta a la pregunta 1 es otra partida
+      if (q == 0) game_++;
+      flipToQuestion(q);
+      return "{\"ok\":true}";
+    }
+
+    uint8_t q;
+    if (isFinalBoard()) {
+      q = 0;
+      game_++;
+    } else if ((uint8_t)(currentQ_ + 1) >= nq_) {
+      enterLeaderboard();
+      return "{\"ok\":true,\"finished\":true}";
+    } else {
+      q = currentQ_ + 1;
+    }
+    flipToQuestion(q);
+    return "{\"ok\":true}";
+  }
+
+  String start() {
+    if (!Rules::kStartResetsRound) {
+      flipToQuestion(currentQ_);
+      return "{\"ok\":true}";
+    }
+
+    game_++;
+    for (auto &p : players_) {
+      if (!p.used) continue;
+      p.score = 0;
+      p.streak = 0;
+      p.bestStreak = 0;
+    }
+    lbDirty_ = true;
+    flipToQuestion(0);
+    return "{\"ok\":true}";
+  }
+
+  // Abre la ventana de unión (fase JOINING); al agotarse vuelve al lobby
+  String openJoin() {
+    if (!Rules::kJoinPhase) return "{\"ok\":false,\"err\":\"Sin fase de unión\"}";
+    if (phase_ != LOBBY) return "{\"ok\":false,\"err\":\"Solo desde el lobby\"}";
+    phase_ = JOINING;
+    phaseStartMs_ = millis();
+    return "{\"ok\":true}";
+  }
+
+  // Solo cierra una pregunta en curso: desde LOBBY o LEADERBOARD no hay nada
+  // que revelar (y el piloto saltaría la pregunta preparada)
+  String reveal() {
+    if (phase_ != QUESTION) return "{\"ok\":false,\"err\":\"No hay pregunta en curso\"}";
+    enterReveal();
+    return "{\"ok\":true}";
+  }
+
+  String reset() {
+    profiles_.save(players_, Rules::kMaxPlayers, game_);
+    for (auto &p : players_) p = Player();
+    nextPlayerId_ = 1;
+    lbDirty_ = true;
+    loadQuestion(0);
+    phase_ = LOBBY;
+    phaseStartMs_ = millis();
+    return "{\"ok\":true}";
+  }
+
+  void setAutoRevealMs(long ms) { autoRevealMs_ = constrain(ms, 1000L, 60000L); }
+  void setAutoBoardMs(long ms) { autoBoardMs_ = constrain(ms, 0L, 60000L); }
+
+  // Al cambiar el modo, la fase REVEAL/LEADERBOARD actual vuelve a contar desde cero
+  void setAutopilot(bool on) {
+    autopilot_ = on;
+    if (phase_ == REVEAL || phase_ == LEADERBOARD) phaseStartMs_ = millis();
+  }
+
+  // Estado del piloto y latencia medida del último cambio a QUESTION (flip_us)
+  String autopilotJson() const {
+    return "{\"ok\":true,\"autopilot\":" + String(autopilot_ ? "true" : "false") +
+           ",\"reveal_ms\":" + String(autoRevealMs_) +
+           ",\"board_ms\":" + String(autoBoardMs_) +
+           ",\"flip_us\":" + String(lastFlipUs_) +
+           ",\"flip_max_us\":" + String(maxFlipUs_) + "}";
+  }
+
+  String league() { return profiles_.leagueJson(); }
+
+  String saveProfiles() {
+    profiles_.save(players_, Rules::kMaxPlayers, game_);
+    return "{\"ok\":" + String(profiles_.ok() ? "true" : "false") + ",\"profiles\":" + String(profiles_.used()) + "}";
+  }
+
+private:
+  Player* findPlayer(uint16_t pid) {
+    for (auto &p : players_) if (p.used && p.id == pid) return &p;
+    return nullptr;
+  }
+
+  uint8_t playerCount() const {
+    uint8_t c=0; for (auto &p : players_) if (p.used) c++;
+    return c;
+  }
+
+  uint8_t playersAnswered() const {
+    uint8_t c=0; for (auto &p : players_) if (p.used && answeredNow(p)) c++;
+    return c;
+  }
+
+  // Cada pregunta abre una ronda nueva: las respuestas anteriores dejan de
+  // contar sin recorrer los jugadores al cambiar de pregunta
+  bool answeredNow(const Player& p) const { return p.answeredRound == round_; }
+
+  // Lo que falta para poder responder la pregunta recién lanzada
+  uint32_t leadInLeftMs() const {
+    if (phase_ != QUESTION) return 0;
+    int32_t left = (int32_t)(questionStartMs_ - millis());
+    return left > 0 ? (uint32_t)left : 0;
+  }
+
+  uint32_t timeLeftMs() const {
+    uint32_t elapsed = millis() - phaseStartMs_;
+    if (phase_ == QUESTION) {
+      if (leadInLeftMs() > 0) return Rules::kQuestionMs;
+      elapsed = millis() - questionStartMs_;
+      if (elapsed >= Rules::kQuestionMs) return 0;
+      return Rules::kQuestionMs - elapsed;
+    }
+    if (Rules::kJoinPhase && phase_ == JOINING) {
+      if (elapsed >= Rules::kJoinMs) return 0;
+      return Rules::kJoinMs - elapsed;
+    }
+    return 0;
+  }
+
+  bool shouldAdvanceFromQuestion() const {
+    if (phase_ != QUESTION) return false;
+    if (timeLeftMs() == 0) return true;
+
+    uint8_t total = 0, answered = 0;
+    for (auto &p : players_) {
+      if (p.used) {
+        total++;
+        if (answeredNow(p)) answered++;
+      }
+    }
+    return (total > 0 && answered == total);
+  }
+
+  // Índice de la pregunta que sigue a la actual, o -1 si la ronda termina
+  int16_t followingQ() const {
+    if ((uint8_t)(currentQ_ + 1) < nq_) return currentQ_ + 1;
+    if (Rules::kWrapOnNext && nq_ > 1) return 0;
+    return -1;
+  }
+
+  // Una clasificación es final cuando ya no quedan preguntas en la ronda
+  bool isFinalBoard() const {
+    return phase_ == LEADERBOARD && (uint8_t)(currentQ_ + 1) >= nq_;
+  }
+
+  uint32_t autopilotLeftMs() const {
+    uint32_t span;
+    if (phase_ == REVEAL) span = autoRevealMs_;
+    else if (phase_ == LEADERBOARD && !isFinalBoard()) span = autoBoardMs_;
+    else return 0;
+    uint32_t elapsed = millis() - phaseStartMs_;
+    if (elapsed >= span) return 0;
+    return span - elapsed;
+  }
+
+  uint32_t nextPollMs(uint32_t tl) const {
+    uint32_t leadIn = leadInLeftMs();
+    bool timed = phase_ == QUESTION || (Rules::kJoinPhase && phase_ == JOINING);
+    uint32_t ms, cap;
+    if (phase_ == QUESTION && leadIn == 0 && tl <= POLL_FINAL_WINDOW_MS) {
+      ms = POLL_FAST_MS;
+      cap = POLL_FINAL_MAX_MS;
+    } else if (timed) {
+      ms = POLL_QUESTION_MS;
+      cap = POLL_SLOW_MS;
+    } else {
+      ms = POLL_WAIT_MS + (millis() - phaseStartMs_) / 2;
+      cap = POLL_IDLE_MAX_MS;
+    }
+
+    // Intervalo con el que todos los jugadores juntos hacen POLL_LOAD_RPS
+    uint32_t loadMs = (uint32_t)playerCount() * 1000UL / POLL_LOAD_RPS;
+    if (ms < loadMs) ms = loadMs;
+    if (ms > cap) ms = cap;
+
+    // No dormir más allá del siguiente cambio previsible
+    bool bounded = timed;
+    uint32_t until = leadIn > 0 ? leadIn : tl;
+    if (!timed && autopilot_ && (phase_ == REVEAL || (phase_ == LEADERBOARD && !isFinalBoard()))) {
+      bounded = true;
+      until = autopilotLeftMs();
+    }
+    if (bounded && ms > until) ms = until < POLL_FAST_MS ? POLL_FAST_MS : until;
+    return ms;
+  }
+
+  String statusText(const Player& me) const {
+    if (phase_ == LOBBY) return "Esperando a que el host inicie...";
+    if (phase_ == JOINING) return "¡Prepárate! La ronda comienza pronto...";
+    bool answered = answeredNow(me);
+    if (phase_ == QUESTION && leadInLeftMs() > 0) return "¡Prepárate! La pregunta empieza enseguida...";
+    if (phase_ == QUESTION) return answered ? "Respuesta enviada ✓" : "Responde antes de que se acabe el tiempo!";
+    if (phase_ == REVEAL) return answered && me.correct ? "¡Correcto! 🎉" : (answered ? "Incorrecto 😅" : "Se acabó el tiempo ⏰");
+    return "";
+  }
+
+  String leaderboardJson(uint8_t maxItems) const {
+    String out = "[";
+    bool first = true;
+
+    bool usedIdx[Rules::kMaxPlayers];
+    for (int i=0;i<Rules::kMaxPlayers;i++) usedIdx[i] = players_[i].used;
+
+    for (uint8_t k=0;k<maxItems;k++) {
+      int best = -1;
+      for (int i=0;i<Rules::kMaxPlayers;i++){
+        if (!usedIdx[i]) continue;
+        if (best<0 || players_[i].score > players_[best].score) best=i;
+      }
+      if (best<0) break;
+      usedIdx[best] = false;
+
+      if (!first) out += ",";
+      first = false;
+      out += "{\"name\":\"" + jsonEscape(players_[best].name) + "\",\"icon\":\"" +
+             String(icons_[players_[best].icon]) + "\",\"score\":" + String(players_[best].score);
+      if (Rules::kLeaderboardStreak) out += ",\"streak\":" + String(players_[best].streak);
+      out += "}";
+    }
+    out += "]";
+    return out;
+  }
+
+  const String& leaderboardSnapshot() {
+    if (lbDirty_) {
+      lbSnapshot_ = leaderboardJson(Rules::kLeaderboardSize);
+      lbDirty_ = false;
+    }
+    return lbSnapshot_;
+  }
+
+  // ---- Transiciones preparadas ----
+  // Durante REVEAL se construye de antemano el fragmento JSON de la siguiente
+  // pregunta y la clasificación; pasar a QUESTION es intercambiar un puntero.
+  String questionJson(uint8_t q) const {
+    const Question& Q = questions_[q];
+    String o;
+    o.reserve(512);
+    o += "\"q_index\":" + String(q) + ",";
+    o += "\"q_text\":\"" + String(Q.q) + "\",";
+    o += "\"q_opts\":[\"" + String(Q.a[0]) + "\",\"" + String(Q.a[1]) + "\",\"" +
+         String(Q.a[2]) + "\",\"" + String(Q.a[3]) + "\"],";
+    o += "\"correct\":" + String(Q.correct) + ",";
+    o += "\"q_img\":\"" + media_.url(q, 0) + "\",";
+    o += "\"q_aud\":\"" + media_.url(q, 1) + "\",";
+    return o;
+  }
+
+  void stageQuestion(uint8_t q) {
+    *stagedPayload_ = questionJson(q);
+    stagedQ_ = q;
+  }
+
+  void loadQuestion(uint8_t q) {
+    currentQ_ = q;
+    *livePayload_ = questionJson(q);
+    stageQuestion(q);
+  }
+
+  void flipToQuestion(uint8_t q) {
+    uint32_t t0 = micros();
+    if (stagedQ_ != q) stageQuestion(q);
+    String* prev = livePayload_;
+    livePayload_ = stagedPayload_;
+    stagedPayload_ = prev;
+    stagedQ_ = -1;
+
+    currentQ_ = q;
+    phase_ = QUESTION;
+    phaseStartMs_ = millis();
+    questionStartMs_ = phaseStartMs_ + QUESTION_LEAD_IN_MS;
+    round_++;
+
+    lastFlipUs_ = micros() - t0;
+    if (lastFlipUs_ > maxFlipUs_) maxFlipUs_ = lastFlipUs_;
+  }
+
+  void enterReveal() {
+    phase_ = REVEAL;
+    phaseStartMs_ = millis();
+    leaderboardSnapshot();
+    int16_t following = followingQ();
+    if (following >= 0) stageQuestion((uint8_t)following);
+    // Fin de la partida: los perfiles se guardan ahora y no al cambiar de pregunta
+    if ((uint8_t)(currentQ_ + 1) >= nq_) profiles_.save(players_, Rules::kMaxPlayers, game_);
+  }
+
+  void enterLeaderboard() {
+    phase_ = LEADERBOARD;
+    phaseStartMs_ = millis();
+    leaderboardSnapshot();
+    // Por si se pasó a la clasificación final sin REVEAL; si no, no queda nada pendiente
+    if (isFinalBoard()) profiles_.save(players_, Rules::kMaxPlayers, game_);
+  }
+
+  const Question* questions_;
+  uint8_t nq_;
+  const char* const* icons_;
+  uint8_t nicons_;
+  const char* pin_;
+
+  Phase phase_ = LOBBY;
+  uint8_t currentQ_ = 0;
+  uint32_t round_ = 1;   // nunca 0: un jugador recién unido no ha respondido
+  uint32_t game_ = 1;    // ídem para Player::countedGame
+  uint32_t questionStartMs_ = 0;
+  uint32_t phaseStartMs_ = 0;
+
+  // Piloto automático: REVEAL y la clasificación intermedia duran un tiempo fijo
+  bool autopilot_ = false;
+  uint32_t autoRevealMs_ = 5000;
+  uint32_t autoBoardMs_ = 5000;
+
+  Player players_[Rules::kMaxPlayers];
+  uint16_t nextPlayerId_ = 1;
+
+  String lbSnapshot_;
+  bool lbDirty_ = true;
+
+  String payloadBuf_[2];
+  String* livePayload_;
+  String* stagedPayload_;
+  int16_t stagedQ_ = -1;
+  uint32_t lastFlipUs_ = 0;
+  uint32_t maxFlipUs_ = 0;
+
+  QuizMedia<Rules::kMaxQuestions> media_;
+  QuizProfiles profiles_;
+};
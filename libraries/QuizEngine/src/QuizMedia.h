@@ -0,0 +1,205 @@
+#pragma once
+#include <WebServer.h>
+#include <LittleFS.h>
+#include "QuizTypes.h"
+
+// ------------------ Multimedia (LittleFS) ------------------
+// Imágenes y audios opcionales por pregunta, servidos desde flash en trozos
+// fijos con un único búfer estático. Cada respuesta se limita a
+// MEDIA_MAX_SLICE bytes para no bloquear /api/answer mientras se transmite:
+// de un fichero mayor, aunque se pida sin Range, solo se envía el primer
+// trozo (206 + Content-Range). <audio> pide el resto por su cuenta y las
+// páginas usan /media.js; un enlace directo o un <img src> a esa URL solo
+// mostraría el principio.
+const size_t MEDIA_CHUNK = 1460;          // un segmento TCP
+const uint32_t MEDIA_MAX_SLICE = 16384;   // bytes máximos por respuesta
+
+struct MediaInfo {
+  uint32_t size;
+  uint32_t etag;
+};
+
+inline const char* mediaMime(const char* path) {
+  const char* dot = strrchr(path, '.');
+  if (!dot) return "application/octet-stream";
+  if (!strcasecmp(dot, ".png")) return "image/png";
+  if (!strcasecmp(dot, ".jpg") || !strcasecmp(dot, ".jpeg")) return "image/jpeg";
+  if (!strcasecmp(dot, ".gif")) return "image/gif";
+  if (!strcasecmp(dot, ".webp")) return "image/webp";
+  if (!strcasecmp(dot, ".svg")) return "image/svg+xml";
+  if (!strcasecmp(dot, ".mp3")) return "audio/mpeg";
+  if (!strcasecmp(dot, ".wav")) return "audio/wav";
+  if (!strcasecmp(dot, ".ogg")) return "audio/ogg";
+  return "application/octet-stream";
+}
+
+// Parte de cliente, común a las páginas de host y jugador: QuizServer la
+// sirve en /media.js. updateMedia(s, img, audio) muestra la multimedia de
+// /api/state, precarga la de la siguiente pregunta y libera la de las pasadas.
+static const char QUIZ_MEDIA_JS[] PROGMEM = R"JS(
+const mediaCache = {};
+
+// Descarga en trozos con Range (el servidor limita cada respuesta) y arma un Blob
+async function fetchMedia(url){
+  const parts = [];
+  let pos = 0, total = 1, type = '';
+  while (pos < total) {
+    const r = await fetch(url, {headers: {Range: `bytes=${pos}-`}});
+    if (r.status === 200) return URL.createObjectURL(await r.blob());
+    if (r.status !== 206) throw new Error('HTTP ' + r.status);
+    const m = /\/(\d+)$/.exec(r.headers.get('Content-Range') || '');
+    total = m ? +m[1] : 0;
+    type = r.headers.get('Content-Type') || type;
+    const b = await r.arrayBuffer();
+    if (!b.byteLength) break;
+    parts.push(b);
+    pos += b.byteLength;
+  }
+  return URL.createObjectURL(new Blob(parts, {type}));
+}
+
+function loadMedia(url){
+  if (!mediaCache[url]) mediaCache[url] = fetchMedia(url).catch(() => { delete mediaCache[url]; return ''; });
+  return mediaCache[url];
+}
+
+function setMedia(el, url){
+  if (!url) {
+    el.style.display = 'none';
+    if (el.dataset.url) { el.removeAttribute('src'); el.dataset.url = ''; }
+    return;
+  }
+  el.style.display = 'block';
+  if (el.dataset.url === url) return;
+  el.dataset.url = url;
+  loadMedia(url).then(u => {
+    if (el.dataset.url !== url) return;
+    if (u) el.src = u;
+    else { el.style.display = 'none'; el.dataset.url = ''; }   // se reintenta en el siguiente sondeo
+  });
+}
+
+function updateMedia(s, imgEl, audEl){
+  const vis = s.q_visible && s.phase !== 4;
+  setMedia(imgEl, vis ? s.q_img : '');
+  setMedia(audEl, vis ? s.q_aud : '');
+  // Durante REVEAL se precarga lo de la siguiente pregunta
+  if (s.phase === 3) {
+    if (s.next_img) loadMedia(s.next_img);
+    if (s.next_aud) loadMedia(s.next_aud);
+  }
+  // Libera los Blob de preguntas pasadas: solo se guardan la actual y la siguiente
+  const next = (s.q_index + 1) % s.q_total;
+  for (const url in mediaCache) {
+    const q = +new URL(url, location.href).searchParams.get('q');
+    if (q === s.q_index || q === next) continue;
+    mediaCache[url].then(u => { if (u) URL.revokeObjectURL(u); });
+    delete mediaCache[url];
+  }
+}
+)JS";
+
+template <uint8_t MaxQ>
+class QuizMedia {
+public:
+  void index(const Question* questions, uint8_t count, bool fsReady) {
+    questions_ = questions;
+    nq_ = count;
+    for (uint8_t q=0;q<nq_;q++) {
+      for (uint8_t k=0;k<2;k++) {
+        info_[q][k] = MediaInfo{0, 0};
+        const char* p = path(q, k);
+        if (!fsReady || !p) continue;
+        File f = LittleFS.open(p, "r");
+        if (!f || f.isDirectory()) continue;
+        uint32_t size = f.size();
+        uint32_t mtime = (uint32_t)f.getLastWrite();
+        f.close();
+        uint32_t h = fnv1a(2166136261UL, p, strlen(p));
+        h = fnv1a(h, &size, sizeof(size));
+        h = fnv1a(h, &mtime, sizeof(mtime));
+        info_[q][k] = MediaInfo{size, h};
+      }
+    }
+  }
+
+  String url(uint8_t q, uint8_t kind) const {
+    if (q >= nq_ || info_[q][kind].size == 0) return "";
+    return "/api/media?q=" + String(q) + "&t=" + String(kind == 0 ? "img" : "aud") +
+           "&v=" + String(info_[q][kind].etag, HEX);
+  }
+
+  void serve(WebServer& server, int q, uint8_t kind) {
+    if (q < 0 || q >= nq_ || info_[q][kind].size == 0) {
+      server.send(404, "text/plain; charset=utf-8", "Sin contenido");
+      return;
+    }
+    const MediaInfo& mi = info_[q][kind];
+    const char* p = path(q, kind);
+
+    // La URL lleva la versión (v=etag), así que el navegador puede cachearla para siempre
+    String etag = "\"" + String(mi.etag, HEX) + "\"";
+    server.sendHeader("ETag", etag);
+    server.sendHeader("Cache-Control", "public, max-age=31536000, immutable");
+    server.sendHeader("Accept-Ranges", "bytes");
+    if (server.header("If-None-Match") == etag) { server.send(304); return; }
+
+    uint32_t start = 0, end = mi.size - 1;
+    bool partial = false;
+    String range = server.header("Range");
+    int dash = range.indexOf('-');
+    if (range.startsWith("bytes=") && dash > 0 && range.indexOf(',') < 0) {
+      String a = range.substring(6, dash);
+      String b = range.substring(dash + 1);
+      a.trim(); b.trim();
+      if (a.length() == 0) {
+        uint32_t n = (uint32_t)b.toInt();
+        start = (n >= mi.size) ? 0 : mi.size - n;
+        if (n == 0) start = mi.size;
+      } else {
+        start = (uint32_t)a.toInt();
+        if (b.length() > 0) end = (uint32_t)b.toInt();
+      }
+      if (start >= mi.size || end < start) {
+        server.sendHeader("Content-Range", "bytes */" + String(mi.size));
+        server.send(416, "text/plain; charset=utf-8", "");
+        return;
+      }
+      if (end >= mi.size) end = mi.size - 1;
+      partial = true;
+    }
+    // Rangos abiertos (bytes=N-) y peticiones sin Range se recortan: el cliente pide el resto después
+    if (end - start + 1 > MEDIA_MAX_SLICE) {
+      end = start + MEDIA_MAX_SLICE - 1;
+      partial = true;
+    }
+    if (partial) server.sendHeader("Content-Range", "bytes " + String(start) + "-" + String(end) + "/" + String(mi.size));
+
+    File f = LittleFS.open(p, "r");
+    if (!f || !f.seek(start)) { server.send(500, "text/plain; charset=utf-8", "Error de lectura"); return; }
+
+    uint32_t left = end - start + 1;
+    server.setContentLength(left);
+    server.send(partial ? 206 : 200, mediaMime(p), "");
+
+    WiFiClient client = server.client();
+    while (left > 0 && client.connected()) {
+      size_t n = f.read(buf_, left < MEDIA_CHUNK ? left : MEDIA_CHUNK);
+      if (n == 0) break;
+      client.write(buf_, n);
+      left -= n;
+      yield();
+    }
+    f.close();
+  }
+
+private:
+  const char* path(uint8_t q, uint8_t kind) const {
+    return kind == 0 ? questions_[q].image : questions_[q].audio;
+  }
+
+  const Question* questions_ = nullptr;
+  uint8_t nq_ = 0;
+  MediaInfo info_[MaxQ][2];   // [pregunta][0 = imagen, 1 = audio]
+  uint8_t buf_[MEDIA_CHUNK];
+};
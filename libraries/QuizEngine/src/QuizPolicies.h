@@ -0,0 +1,62 @@
+#pragma once
+#include <Arduino.h>
+
+// ------------------ Políticas de juego ------------------
+// QuizGame<Rules> lee todas sus reglas de un struct de políticas. Son
+// constantes de compilación: las ramas de funciones desactivadas (fase
+// JOINING, texto de estado, ...) las elimina el compilador.
+//
+// Un preset define:
+//   Scoring             puntos por respuesta correcta (ver LinearTimeScoring)
+//   kMaxPlayers         jugadores simultáneos
+//   kMaxQuestions       tamaño máximo del banco de preguntas
+//   kNameLen            longitud máxima del nombre mostrado
+//   kLeaderboardSize    entradas de la clasificación en /api/state
+//   kQuestionMs         tiempo por pregunta
+//   kJoinPhase/kJoinMs  fase JOINING con su ventana de unión
+//   kWrapOnNext         "siguiente" tras la última pregunta vuelve a la primera
+//                       en lugar de mostrar la clasificación final
+//   kStartResetsRound   "iniciar" empieza en la pregunta 1 con marcadores a cero;
+//                       si no, solo relanza la pregunta actual
+//   kStatusText         me_status con el texto de estado del jugador
+//   kLeaderboardStreak  la clasificación incluye la racha
+
+// Base + TimeBonus * (tiempo restante / tiempo total) + StreakBonus * racha
+template <uint32_t Base, uint32_t TimeBonus, uint32_t StreakBonus>
+struct LinearTimeScoring {
+  static uint32_t points(uint32_t timeLeftMs, uint32_t questionMs, int32_t streak) {
+    return Base + (timeLeftMs * TimeBonus) / questionMs + (uint32_t)streak * StreakBonus;
+  }
+};
+
+// Reglas de ESP32_kajut: partida lineal que termina en la clasificación final
+struct KajutRules {
+  typedef LinearTimeScoring<100, 400, 50> Scoring;
+  static constexpr uint8_t kMaxPlayers = 50;
+  static constexpr uint8_t kMaxQuestions = 32;
+  static constexpr uint8_t kNameLen = 16;
+  static constexpr uint8_t kLeaderboardSize = 10;
+  static constexpr uint32_t kQuestionMs = 20000;
+  static constexpr bool kJoinPhase = false;
+  static constexpr uint32_t kJoinMs = 0;
+  static constexpr bool kWrapOnNext = false;
+  static constexpr bool kStartResetsRound = true;
+  static constexpr bool kStatusText = false;
+  static constexpr bool kLeaderboardStreak = false;
+};
+
+// Reglas de esp32_quiz_mejorado: preguntas en bucle, fase JOINING y textos de estado
+struct MejoradoRules {
+  typedef LinearTimeScoring<100, 400, 50> Scoring;
+  static constexpr uint8_t kMaxPlayers = 50;
+  static constexpr uint8_t kMaxQuestions = 32;
+  static constexpr uint8_t kNameLen = 16;
+  static constexpr uint8_t kLeaderboardSize = 10;
+  static constexpr uint32_t kQuestionMs = 20000;
+  static constexpr bool kJoinPhase = true;
+  static constexpr uint32_t kJoinMs = 10000;
+  static constexpr bool kWrapOnNext = true;
+  static constexpr bool kStartResetsRound = false;
+  static constexpr bool kStatusText = true;
+  static constexpr bool kLeaderboardStreak = true;
+};
@@ -0,0 +1,212 @@
+#pragma once
+#include <LittleFS.h>
+#include "QuizTypes.h"
+
+// ------------------ Perfiles persistentes ------------------
+// Tabla hash de direccionamiento abierto (sondeo lineal) guardada en
+// LittleFS: cabecera + PROFILE_SLOTS registros de tamaño fijo. Solo se lee
+// la ranura buscada, así que miles de alumnos no ocupan RAM. Los cambios
+// de la partida se acumulan en Player y se escriben juntos al revelar la
+// última pregunta (o en la clasificación final, /api/host/save y reset),
+// nunca en el cambio de pregunta. Si una partida se interrumpe antes, lo
+// pendiente se guarda con la siguiente.
+const char* const PROFILE_DB = "/profiles.db";
+const uint32_t PROFILE_MAGIC = 0x32465250;
+const uint16_t PROFILE_SLOTS = 4096;   // potencia de 2
+const uint16_t PROFILE_MAX_USED = PROFILE_SLOTS / 4 * 3;
+const uint8_t PROFILE_BLOCK = 16;
+const uint8_t PROFILE_LEAGUE_SIZE = 10;
+
+struct ProfileHeader {
+  uint32_t magic;
+  uint16_t slots;
+  uint16_t used;
+};
+
+struct ProfileRec {
+  uint32_t hash;   // profileHash(key), 0 = ranura vacía
+  char key[20];    // nombre o token normalizado: identifica al alumno
+  char name[20];   // nombre visible de la última partida guardada
+  uint32_t totalScore;
+  uint32_t answered;
+  uint32_t correct;
+  uint16_t games;
+  uint16_t bestStreak;
+};
+
+// Minúsculas, sin espacios en los extremos y con los espacios internos colapsados
+inline String normalizeKey(const String& s) {
+  String o; o.reserve(s.length());
+  bool space = false;
+  for (size_t i=0;i<s.length();i++) {
+    char c = s[i];
+    if (c==' ' || c=='\t' || c=='\r' || c=='\n') { space = o.length() > 0; continue; }
+    if (space) { o += ' '; space = false; }
+    if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+    o += c;
+  }
+  return o.substring(0, sizeof(ProfileRec::key) - 1);
+}
+
+inline uint32_t profileHash(const String& key) {
+  uint32_t h = fnv1a(2166136261UL, key.c_str(), key.length());
+  return h ? h : 1;
+}
+
+inline uint32_t profileOffset(uint16_t slot) {
+  return sizeof(ProfileHeader) + (uint32_t)slot * sizeof(ProfileRec);
+}
+
+inline String profileJson(const ProfileRec& rec) {
+  uint32_t acc = rec.answered ? (rec.correct * 100UL) / rec.answered : 0;
+  return "{\"name\":\"" + jsonEscape(String(rec.name)) + "\",\"games\":" + String(rec.games) +
+         ",\"score\":" + String(rec.totalScore) + ",\"accuracy\":" + String(acc) +
+         ",\"best_streak\":" + String(rec.bestStreak) + "}";
+}
+
+class QuizProfiles {
+public:
+  bool ok() const { return ok_; }
+  uint16_t used() const { return hdr_.used; }
+
+  void open(bool fsReady) {
+    ok_ = false;
+    if (!fsReady) return;
+
+    File f = LittleFS.open(PROFILE_DB, "r");
+    if (f) {
+      bool valid = f.read((uint8_t*)&hdr_, sizeof(hdr_)) == sizeof(hdr_) &&
+                   hdr_.magic == PROFILE_MAGIC && hdr_.slots == PROFILE_SLOTS &&
+                   f.size() == profileOffset(PROFILE_SLOTS);
+      f.close();
+      if (valid) { ok_ = true; return; }
+    }
+
+    f = LittleFS.open(PROFILE_DB, "w");
+    if (!f) return;
+    hdr_ = ProfileHeader{PROFILE_MAGIC, PROFILE_SLOTS, 0};
+    f.write((const uint8_t*)&hdr_, sizeof(hdr_));
+    uint8_t zero[256];
+    memset(zero, 0, sizeof(zero));
+    uint32_t left = (uint32_t)PROFILE_SLOTS * sizeof(ProfileRec);
+    while (left > 0) {
+      size_t n = left < sizeof(zero) ? left : sizeof(zero);
+      if (f.write(zero, n) != n) { f.close(); return; }
+      left -= n;
+    }
+    f.close();
+    ok_ = true;
+  }
+
+  bool lookup(const String& key, ProfileRec& rec) {
+    if (!ok_ || key.length() == 0) return false;
+    File f = LittleFS.open(PROFILE_DB, "r");
+    if (!f) return false;
+    int32_t slot = probe(f, key, rec);
+    f.close();
+    return slot >= 0 && rec.hash != 0;
+  }
+
+  // Vuelca de una vez lo acumulado por cada jugador desde el último guardado.
+  // Cada clave suma una partida por cada `game` distinto, aunque el alumno
+  // ocupe varias ranuras (recargó la página o comparte nombre con otro)
+  void save(Player* players, uint8_t count, uint32_t game) {
+    if (!ok_) return;
+    bool pending = false;
+    for (uint8_t i=0;i<count;i++) if (players[i].used && players[i].profAnswered) pending = true;
+    if (!pending) return;
+    File f = LittleFS.open(PROFILE_DB, "r+");
+    if (!f) return;
+
+    ProfileRec rec;
+    for (uint8_t i=0;i<count;i++) {
+      Player& p = players[i];
+      if (!p.used || p.profileKey.length() == 0 || p.profAnswered == 0) continue;
+      int32_t slot = probe(f, p.profileKey, rec);
+      if (slot < 0) continue;
+      if (rec.hash == 0) {
+        if (hdr_.used >= PROFILE_MAX_USED) continue;
+        memset(&rec, 0, sizeof(rec));
+        rec.hash = profileHash(p.profileKey);
+        strncpy(rec.key, p.profileKey.c_str(), sizeof(rec.key) - 1);
+        hdr_.used++;
+      }
+      memset(rec.name, 0, sizeof(rec.name));
+      strncpy(rec.name, p.name.c_str(), sizeof(rec.name) - 1);
+      if (p.countedGame != game) {
+        bool counted = false;
+        for (uint8_t j=0;j<count && !counted;j++) {
+          const Player& o = players[j];
+          counted = j != i && o.used && o.countedGame == game && o.profileKey == p.profileKey;
+        }
+        if (!counted) rec.games++;
+        p.countedGame = game;
+      }
+      rec.totalScore += p.profGained;
+      rec.answered += p.profAnswered;
+      rec.correct += p.profCorrect;
+      if (p.bestStreak > rec.bestStreak) rec.bestStreak = p.bestStreak;
+
+      f.seek(profileOffset(slot));
+      f.write((const uint8_t*)&rec, sizeof(rec));
+      p.profGained = 0;
+      p.profAnswered = 0;
+      p.profCorrect = 0;
+    }
+
+    f.seek(0);
+    f.write((const uint8_t*)&hdr_, sizeof(hdr_));
+    f.close();
+  }
+
+  String leagueJson() {
+    if (!ok_) return "{\"ok\":false,\"err\":\"Sin perfiles\"}";
+    File f = LittleFS.open(PROFILE_DB, "r");
+    if (!f) return "{\"ok\":false,\"err\":\"Sin perfiles\"}";
+
+    ProfileRec top[PROFILE_LEAGUE_SIZE];
+    uint8_t n = 0;
+    ProfileRec block[PROFILE_BLOCK];
+    f.seek(profileOffset(0));
+    for (uint16_t s=0;s<PROFILE_SLOTS;s+=PROFILE_BLOCK) {
+      size_t got = f.read((uint8_t*)block, sizeof(block)) / sizeof(ProfileRec);
+      for (size_t i=0;i<got;i++) {
+        const ProfileRec& r = block[i];
+        if (r.hash == 0) continue;
+        if (n == PROFILE_LEAGUE_SIZE && r.totalScore <= top[PROFILE_LEAGUE_SIZE-1].totalScore) continue;
+        uint8_t pos = (n < PROFILE_LEAGUE_SIZE) ? n++ : PROFILE_LEAGUE_SIZE - 1;
+        while (pos > 0 && top[pos-1].totalScore < r.totalScore) { top[pos] = top[pos-1]; pos--; }
+        top[pos] = r;
+      }
+      if (got < PROFILE_BLOCK) break;
+    }
+    f.close();
+
+    String body = "{\"ok\":true,\"profiles\":" + String(hdr_.used) + ",\"league\":[";
+    for (uint8_t i=0;i<n;i++) {
+      if (i) body += ",";
+      body += profileJson(top[i]);
+    }
+    body += "]}";
+    return body;
+  }
+
+private:
+  // Devuelve la ranura del perfil o la primera vacía de su secuencia de sondeo
+  // (rec.hash == 0 en ese caso); -1 si no hay sitio o falla la lectura
+  int32_t probe(File& f, const String& key, ProfileRec& rec) {
+    uint32_t h = profileHash(key);
+    uint16_t slot = h & (PROFILE_SLOTS - 1);
+    for (uint16_t i=0;i<PROFILE_SLOTS;i++) {
+      if (!f.seek(profileOffset(slot))) return -1;
+      if (f.read((uint8_t*)&rec, sizeof(rec)) != sizeof(rec)) return -1;
+      if (rec.hash == 0) return slot;
+      if (rec.hash == h && strncmp(rec.key, key.c_str(), sizeof(rec.key)) == 0) return slot;
+      slot = (slot + 1) & (PROFILE_SLOTS - 1);
+    }
+    return -1;
+  }
+
+  bool ok_ = false;
+  ProfileHeader hdr_ = {0, 0, 0};
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include <WebServer.h>
+#include "QuizGame.h"
+
+// ------------------ Rutas ------------------
+// Traduce las peticiones HTTP a operaciones de QuizGame y envía su JSON.
+// Las páginas del host y del jugador las aporta cada sketch; el código de
+// multimedia que comparten se sirve en /media.js.
+template <class Rules>
+class QuizServer {
+public:
+  QuizServer(WebServer& server, QuizGame<Rules>& game) : server_(server), game_(game) {}
+
+  void begin(const char* hostHtml, const char* playHtml) {
+    hostHtml_ = hostHtml;
+    playHtml_ = playHtml;
+
+    server_.on("/", [this](){ server_.send(200, "text/html; charset=utf-8",
+      "<div style='font-family:sans-serif;text-align:center;margin-top:50px;'>"
+      "<h1>🧪 ESP32 Quiz</h1>"
+      "<p><a href='/host' style='display:inline-block;padding:12px 24px;margin:8px;background:#FF6B6B;color:white;text-decoration:none;border-radius:8px;'>Panel del Host</a></p>"
+      "<p><a href='/play' style='display:inline-block;padding:12px 24px;margin:8px;background:#4ECDC4;color:white;text-decoration:none;border-radius:8px;'>Unirse como Jugador</a></p>"
+      "</div>"); });
+
+    server_.on("/host", [this](){ server_.send(200, "text/html; charset=utf-8", FPSTR(hostHtml_)); });
+    server_.on("/play", [this](){ server_.send(200, "text/html; charset=utf-8", FPSTR(playHtml_)); });
+    server_.on("/media.js", [this](){ server_.send(200, "application/javascript; charset=utf-8", FPSTR(QUIZ_MEDIA_JS)); });
+
+    server_.on("/api/join", [this](){
+      sendJson(game_.join(arg("pin"), arg("name"), arg("token")));
+    });
+    server_.on("/api/answer", [this](){
+      if (!server_.hasArg("pid") || !server_.hasArg("opt")) { sendJson("{\"ok\":false}"); return; }
+      sendJson(game_.answer((uint16_t)server_.arg("pid").toInt(), server_.arg("opt").toInt()));
+    });
+    server_.on("/api/state", [this](){
+      uint16_t pid = server_.hasArg("pid") ? (uint16_t)server_.arg("pid").toInt() : 0;
+      sendJson(game_.state(pid));
+    });
+    server_.on("/api/media", [this](){
+      int q = server_.hasArg("q") ? server_.arg("q").toInt() : -1;
+      uint8_t kind = (server_.arg("t") == "aud") ? 1 : 0;
+      game_.serveMedia(server_, q, kind);
+    });
+
+    server_.on("/api/host/next", [this](){ sendJson(game_.next()); });
+    server_.on("/api/host/start", [this](){ sendJson(game_.start()); });
+    server_.on("/api/host/reveal", [this](){ sendJson(game_.reveal()); });
+    if (Rules::kJoinPhase) server_.on("/api/host/join", [this](){ sendJson(game_.openJoin()); });
+    server_.on("/api/host/reset", [this](){ sendJson(game_.reset()); });
+    // ?on=0|1&reveal_ms=N&board_ms=N — sin argumentos solo informa del estado
+    server_.on("/api/host/autopilot", [this](){
+      if (server_.hasArg("reveal_ms")) game_.setAutoRevealMs(server_.arg("reveal_ms").toInt());
+      if (server_.hasArg("board_ms")) game_.setAutoBoardMs(server_.arg("board_ms").toInt());
+      if (server_.hasArg("on")) game_.setAutopilot(server_.arg("on").toInt() != 0);
+      sendJson(game_.autopilotJson());
+    });
+    server_.on("/api/host/league", [this](){ sendJson(game_.league()); });
+    server_.on("/api/host/save", [this](){ sendJson(game_.saveProfiles()); });
+
+    const char* mediaHeaders[] = {"Range", "If-None-Match"};
+    server_.collectHeaders(mediaHeaders, 2);
+  }
+
+private:
+  String arg(const char* name) { return server_.hasArg(name) ? server_.arg(name) : ""; }
+
+  void sendJson(const String& body) {
+    server_.send(200, "application/json; charset=utf-8", body);
+  }
+
+  WebServer& server_;
+  QuizGame<Rules>& game_;
+  const char* hostHtml_ = nullptr;
+  const char* playHtml_ = nullptr;
+};
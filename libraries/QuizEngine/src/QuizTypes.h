@@ -0,0 +1,51 @@
+#pragma once
+#include <Arduino.h>
+
+// ------------------ Tipos comunes ------------------
+struct Question {
+  const char* q;
+  const char* a[4];
+  uint8_t correct;
+  const char* image;   // ruta opcional en LittleFS
+  const char* audio;
+};
+
+enum Phase : uint8_t { LOBBY=0, JOINING=1, QUESTION=2, REVEAL=3, LEADERBOARD=4 };
+
+struct Player {
+  bool used = false;
+  uint16_t id = 0;
+  String name;
+  uint8_t icon = 0;
+  int32_t score = 0;
+  int32_t streak = 0;
+  uint32_t answeredRound = 0;   // ronda (QuizGame::round_) de la última respuesta
+  int8_t answer = -1;
+  bool correct = false;
+  uint32_t answerTime = 0;
+  bool joinedThisRound = false;
+  String profileKey;
+  uint32_t profGained = 0;
+  uint16_t profAnswered = 0;
+  uint16_t profCorrect = 0;
+  uint16_t bestStreak = 0;
+  uint32_t countedGame = 0;     // partida (QuizGame::game_) ya sumada a su perfil
+};
+
+inline String jsonEscape(const String& s) {
+  String o; o.reserve(s.length()+8);
+  for (size_t i=0;i<s.length();i++){
+    char c=s[i];
+    if (c=='"') o += "\\\"";
+    else if (c=='\\') o += "\\\\";
+    else if (c=='\n') o += "\\n";
+    else o += c;
+  }
+  return o;
+}
+
+inline uint32_t fnv1a(uint32_t h, const void* data, size_t n) {
+  const uint8_t* d = (const uint8_t*)data;
+  for (size_t i=0;i<n;i++) { h ^= d[i]; h *= 16777619UL; }
+  return h;
+}